@@ -2,6 +2,7 @@
 #include <iomanip>
 #include <iostream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <cxxopts.hpp>
@@ -36,6 +37,7 @@ struct Row {
   double gpu_ms, cpu_ms;
   double gpu_gitems_s, cpu_gitems_s;
   double upsweep_ms, spine_ms, downsweep_ms;  // summed across 4 passes; 0 for non-Vulkan
+  double copy_ms;                             // buffer copy of the same size; scan only
 };
 
 bool checkCorrectness(BenchmarkBase* bench, BenchmarkBase* cpu, uint32_t n, DataGenerator& gen) {
@@ -63,35 +65,238 @@ bool checkCorrectness(BenchmarkBase* bench, BenchmarkBase* cpu, uint32_t n, Data
   return true;
 }
 
+bool checkScanCorrectness(BenchmarkBase* bench, BenchmarkBase* cpu, uint32_t n,
+                          DataGenerator& gen) {
+  auto data = gen.Generate(n);
+
+  auto r0 = bench->ExclusiveScan(data.values);
+  auto r1 = cpu->ExclusiveScan(data.values);
+  if (r0.keys.size() != n) {
+    std::cerr << "ExclusiveScan is not supported by this backend" << std::endl;
+    return false;
+  }
+  for (uint32_t i = 0; i < n; ++i) {
+    if (r0.keys[i] != r1.keys[i]) {
+      std::cerr << "ExclusiveScan correctness failed at index " << i << std::endl;
+      return false;
+    }
+  }
+
+  std::cout << "Scan correctness check passed (N=" << n << ")" << std::endl;
+  return true;
+}
+
+bool compare(const std::string& name, const std::vector<uint32_t>& lhs,
+             const std::vector<uint32_t>& rhs) {
+  if (lhs.size() != rhs.size()) {
+    std::cerr << name << " correctness failed: size " << lhs.size() << " != " << rhs.size()
+              << std::endl;
+    return false;
+  }
+  for (size_t i = 0; i < lhs.size(); ++i) {
+    if (lhs[i] != rhs[i]) {
+      std::cerr << name << " correctness failed at index " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool compare(const std::string& name, const BenchmarkBase::Results& lhs,
+             const BenchmarkBase::Results& rhs) {
+  return compare(name, lhs.keys, rhs.keys) && compare(name, lhs.values, rhs.values);
+}
+
+// Checks other primitives of the library against the std:: references of the CPU backend.
+bool checkPrimitivesCorrectness(BenchmarkBase* bench, BenchmarkBase* cpu, uint32_t n,
+                                DataGenerator& gen) {
+  auto data = gen.Generate(n);
+  // duplicate keys check stability
+  auto narrow = gen.Generate(n, 16);
+
+  // executed twice on the same buffers
+  if (!compare("SortPlan", bench->SortPlan(narrow.keys, narrow.values),
+               cpu->SortPlan(narrow.keys, narrow.values)))
+    return false;
+
+  // key-value and keys only sorts of different sizes
+  std::vector<std::vector<uint32_t>> batch_keys, batch_values;
+  for (uint32_t size : {n / 2, n / 4, 1000u}) {
+    auto batch = gen.Generate(size, 16);
+    batch_keys.push_back(batch.keys);
+    batch_values.push_back(batch.values);
+  }
+  batch_values[1].clear();
+  if (!compare("SortBatch", bench->SortBatch(batch_keys, batch_values),
+               cpu->SortBatch(batch_keys, batch_values)))
+    return false;
+
+  // segments of up to 16K elements, both sorted in shared memory and by partitions
+  std::vector<uint32_t> segment_offsets = {0};
+  for (uint32_t size : gen.Generate(n, 14).keys) {
+    if (segment_offsets.back() + size >= n) break;
+    segment_offsets.push_back(segment_offsets.back() + size);
+  }
+  segment_offsets.push_back(n);
+  if (!compare("SortSegmented", bench->SortSegmented(data.keys, segment_offsets),
+               cpu->SortSegmented(data.keys, segment_offsets)))
+    return false;
+
+  if (!compare("Argsort", bench->Argsort(narrow.keys), cpu->Argsort(narrow.keys))) return false;
+
+  for (uint32_t value_words : {2u, 4u}) {
+    auto values = gen.Generate(value_words * n).values;
+    if (!compare("SortKeyValueWide", bench->SortKeyValueWide(narrow.keys, values, value_words),
+                 cpu->SortKeyValueWide(narrow.keys, values, value_words)))
+      return false;
+  }
+
+  std::vector<std::vector<uint32_t>> value_streams;
+  for (int i = 0; i < 3; ++i) value_streams.push_back(gen.Generate(n).values);
+  if (!compare("SortKeyValueStreams", bench->SortKeyValueStreams(narrow.keys, value_streams),
+               cpu->SortKeyValueStreams(narrow.keys, value_streams)))
+    return false;
+
+  // records of 4 words are moved as uint4
+  auto permutation = cpu->Argsort(data.keys).values;
+  for (uint32_t record_words : {3u, 4u}) {
+    auto records = gen.Generate(record_words * n).values;
+    if (!compare("GatherScatter", bench->GatherScatter(records, record_words, permutation),
+                 cpu->GatherScatter(records, record_words, permutation)))
+      return false;
+  }
+
+  auto records = gen.Generate(3 * n, 16).keys;
+  if (!compare("SortRecords", bench->SortRecords(records, 3, 1), cpu->SortRecords(records, 3, 1)))
+    return false;
+
+  if (!compare("SortCopy", bench->SortCopy(narrow.keys, narrow.values),
+               cpu->SortCopy(narrow.keys, narrow.values)))
+    return false;
+
+  if (!compare("SortPingPong", bench->SortPingPong(narrow.keys, narrow.values),
+               cpu->SortPingPong(narrow.keys, narrow.values)))
+    return false;
+
+  // 32-bit keys split down to small buckets, and few distinct keys left in large ones
+  for (const SortData* sort_data : {&data, &narrow}) {
+    if (!compare("SortInPlace", bench->SortInPlace(sort_data->keys, sort_data->values),
+                 cpu->SortInPlace(sort_data->keys, sort_data->values)))
+      return false;
+  }
+
+  // buckets sorted in shared memory, and all keys in one bucket sorted by the fallback
+  auto clustered = gen.Generate(n, 12);
+  for (const SortData* sort_data : {&data, &clustered}) {
+    if (!compare("SortHybrid", bench->SortHybrid(sort_data->keys, sort_data->values),
+                 cpu->SortHybrid(sort_data->keys, sort_data->values)))
+      return false;
+  }
+
+  // sorted keys with swapped neighbors are resolved in windows, random keys fall back to a sort
+  auto nearly_sorted = cpu->SortKeyValue(narrow.keys, narrow.values);
+  for (uint32_t i = 0; i + 1 < n; i += 97) {
+    std::swap(nearly_sorted.keys[i], nearly_sorted.keys[i + 1]);
+  }
+  if (!compare("SortCoherent", bench->SortCoherent(nearly_sorted.keys, nearly_sorted.values),
+               cpu->SortCoherent(nearly_sorted.keys, nearly_sorted.values)) ||
+      !compare("SortCoherent", bench->SortCoherent(data.keys, data.values),
+               cpu->SortCoherent(data.keys, data.values)))
+    return false;
+
+  auto a = gen.Generate(n / 2, 16);
+  auto b = gen.Generate(n - n / 2, 16);
+  auto sorted_a = cpu->SortKeyValue(a.keys, a.values);
+  auto sorted_b = cpu->SortKeyValue(b.keys, b.values);
+  if (!compare("Merge",
+               bench->Merge(sorted_a.keys, sorted_a.values, sorted_b.keys, sorted_b.values),
+               cpu->Merge(sorted_a.keys, sorted_a.values, sorted_b.keys, sorted_b.values)))
+    return false;
+
+  std::vector<std::vector<uint32_t>> insert_batches;
+  for (int i = 0; i < 3; ++i) insert_batches.push_back(gen.Generate(n / 4, 16).keys);
+  auto erase_keys = gen.Generate(4096, 16).keys;
+  if (!compare("SortedSet", bench->SortedSet(insert_batches, erase_keys),
+               cpu->SortedSet(insert_batches, erase_keys)))
+    return false;
+
+  if (!compare("Select", bench->Select(data.keys, n / 3), cpu->Select(data.keys, n / 3)))
+    return false;
+
+  // runs of equal keys cross partitions
+  auto runs = gen.Generate(n, 12);
+  auto sorted_runs = cpu->SortKeyValue(runs.keys, runs.values);
+  if (!compare("Unique", bench->Unique(sorted_runs.keys, sorted_runs.values),
+               cpu->Unique(sorted_runs.keys, sorted_runs.values)) ||
+      !compare("RunLengthEncode", bench->RunLengthEncode(sorted_runs.keys),
+               cpu->RunLengthEncode(sorted_runs.keys)))
+    return false;
+  if (!compare("ReduceByKey", bench->ReduceByKey(sorted_runs.keys, sorted_runs.values),
+               cpu->ReduceByKey(sorted_runs.keys, sorted_runs.values)))
+    return false;
+
+  // from the top digit offsets, and from a pass over keys
+  for (uint32_t prefix_bits : {8u, 12u}) {
+    if (!compare("SortBoundaries", bench->SortBoundaries(data.keys, prefix_bits),
+                 cpu->SortBoundaries(data.keys, prefix_bits)))
+      return false;
+  }
+
+  auto sorted_keys = cpu->Sort(gen.Generate(n, 20).keys).keys;
+  auto queries = gen.Generate(n / 2, 20).keys;
+  if (!compare("Search", bench->Search(sorted_keys, queries), cpu->Search(sorted_keys, queries)))
+    return false;
+
+  auto left_keys = gen.Generate(n / 4, 16).keys;
+  auto right_keys = gen.Generate(n / 4, 16).keys;
+  if (!compare("Join", bench->Join(left_keys, right_keys), cpu->Join(left_keys, right_keys)))
+    return false;
+
+  // buckets of 5 values of a 12-bit digit
+  if (!compare("Histogram", bench->Histogram(data.keys, 4, 12, 1000),
+               cpu->Histogram(data.keys, 4, 12, 1000)))
+    return false;
+
+  if (!compare("Multisplit", bench->Multisplit(data.keys, data.values, 8, 5),
+               cpu->Multisplit(data.keys, data.values, 8, 5)))
+    return false;
+
+  std::cout << "Primitives correctness check passed (N=" << n << ")" << std::endl;
+  return true;
+}
+
+BenchmarkBase::Results run(BenchmarkBase* bench, const std::string& sort,
+                           const SortData& data) {
+  if (sort == "keys") return bench->Sort(data.keys);
+  if (sort == "scan") return bench->ExclusiveScan(data.values);
+  return bench->SortKeyValue(data.keys, data.values);
+}
+
 Row measure(BenchmarkBase* bench, uint32_t n, const std::string& sort, DataGenerator& gen) {
   // warmup
   for (int i = 0; i < kWarmupRuns; ++i) {
     auto data = gen.Generate(n);
-    if (sort == "keys")
-      bench->Sort(data.keys);
-    else
-      bench->SortKeyValue(data.keys, data.values);
+    run(bench, sort, data);
   }
 
-  std::vector<uint64_t> gpu_times, cpu_times, upsweep_times, spine_times, downsweep_times;
+  std::vector<uint64_t> gpu_times, cpu_times, upsweep_times, spine_times, downsweep_times,
+      copy_times;
   gpu_times.reserve(kTimedRuns);
   cpu_times.reserve(kTimedRuns);
   upsweep_times.reserve(kTimedRuns);
   spine_times.reserve(kTimedRuns);
   downsweep_times.reserve(kTimedRuns);
+  copy_times.reserve(kTimedRuns);
 
   for (int i = 0; i < kTimedRuns; ++i) {
     auto data = gen.Generate(n);
-    BenchmarkBase::Results r;
-    if (sort == "keys")
-      r = bench->Sort(data.keys);
-    else
-      r = bench->SortKeyValue(data.keys, data.values);
+    BenchmarkBase::Results r = run(bench, sort, data);
     gpu_times.push_back(r.total_time);
     cpu_times.push_back(r.cpu_time);
     upsweep_times.push_back(r.upsweep_ns);
     spine_times.push_back(r.spine_ns);
     downsweep_times.push_back(r.downsweep_ns);
+    copy_times.push_back(r.copy_time);
   }
 
   uint64_t gpu_med = median(gpu_times);
@@ -99,6 +304,7 @@ Row measure(BenchmarkBase* bench, uint32_t n, const std::string& sort, DataGener
   uint64_t up_med = median(upsweep_times);
   uint64_t sp_med = median(spine_times);
   uint64_t dn_med = median(downsweep_times);
+  uint64_t copy_med = median(copy_times);
 
   return Row{n,
              sort,
@@ -108,7 +314,8 @@ Row measure(BenchmarkBase* bench, uint32_t n, const std::string& sort, DataGener
              toGItemsS(n, cpu_med),
              toMs(up_med),
              toMs(sp_med),
-             toMs(dn_med)};
+             toMs(dn_med),
+             toMs(copy_med)};
 }
 
 }  // namespace
@@ -118,6 +325,7 @@ int main(int argc, char** argv) {
   options.add_options()("type", "Backend type", cxxopts::value<std::string>())(
       "o,output", "Output CSV file", cxxopts::value<std::string>()->default_value("results.csv"))(
       "validation", "Enable Vulkan validation layers")(
+      "scan", "Benchmark exclusive scan against a buffer copy instead of sorts")(
       "no-verify", "Skip correctness check and proceed to benchmarking")("h,help", "Print usage");
   options.parse_positional({"type"});
   options.positional_help("<type>");
@@ -145,6 +353,7 @@ int main(int argc, char** argv) {
   std::string csv_path = result["output"].as<std::string>();
   bool validation = result.count("validation") > 0;
   bool no_verify = result.count("no-verify") > 0;
+  bool scan = result.count("scan") > 0;
 
   std::unique_ptr<BenchmarkBase> bench, cpu;
   try {
@@ -162,10 +371,16 @@ int main(int argc, char** argv) {
     uint32_t n = kNMin + static_cast<uint32_t>(i) * kNStep;
 
     if (i == 0 && !no_verify) {
-      if (!checkCorrectness(bench.get(), cpu.get(), n, gen)) return 1;
+      if (scan ? !checkScanCorrectness(bench.get(), cpu.get(), n, gen)
+               : !checkCorrectness(bench.get(), cpu.get(), n, gen))
+        return 1;
+      if (bench->HasPrimitives() && !checkPrimitivesCorrectness(bench.get(), cpu.get(), n, gen))
+        return 1;
     }
 
-    for (const std::string& sort : {"keys", "kv"}) {
+    std::vector<std::string> sorts = scan ? std::vector<std::string>{"scan"}
+                                          : std::vector<std::string>{"keys", "kv"};
+    for (const std::string& sort : sorts) {
       Row row = measure(bench.get(), n, sort, gen);
       rows.push_back(row);
 
@@ -184,6 +399,13 @@ int main(int argc, char** argv) {
                   << " sp=" << row.spine_ms << "ms(" << pct(row.spine_ms) << "%)"
                   << " dn=" << row.downsweep_ms << "ms(" << pct(row.downsweep_ms) << "%)" << "]";
       }
+      if (row.copy_ms > 0) {
+        // a copy reads and writes each element once, the bandwidth bound of a scan
+        double copy_gitems_s = toGItemsS(n, static_cast<uint64_t>(row.copy_ms * 1e6));
+        std::cout << std::fixed << std::setprecision(3) << "  [copy=" << row.copy_ms << "ms ("
+                  << std::setprecision(2) << copy_gitems_s << " GItems/s)]";
+        rows.push_back(Row{n, "copy", row.copy_ms, 0., copy_gitems_s, 0., 0., 0., 0., 0.});
+      }
       std::cout << std::endl;
     }
   }
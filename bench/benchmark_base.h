@@ -15,6 +15,7 @@ class BenchmarkBase {
     uint64_t upsweep_ns = 0;    // ns, summed across 4 passes
     uint64_t spine_ns = 0;      // ns, summed across 4 passes
     uint64_t downsweep_ns = 0;  // ns, summed across 4 passes
+    uint64_t copy_time = 0;     // ns (GPU timestamps, buffer copy of the same size)
   };
 
  public:
@@ -26,6 +27,148 @@ class BenchmarkBase {
   virtual Results Sort(const std::vector<uint32_t>& keys) = 0;
   virtual Results SortKeyValue(const std::vector<uint32_t>& keys,
                                const std::vector<uint32_t>& values) = 0;
+
+  // Exclusive prefix sum of values, returned in keys. Empty keys if not supported.
+  virtual Results ExclusiveScan(const std::vector<uint32_t>& values) { return {}; }
+
+  // Primitives below are checked against CpuBenchmark if supported.
+  virtual bool HasPrimitives() const { return false; }
+
+  // Key-value sort recorded from a sort plan, executed twice on the same buffers.
+  virtual Results SortPlan(const std::vector<uint32_t>& keys, const std::vector<uint32_t>& values) {
+    return {};
+  }
+
+  // Independent sorts of keys[i] with values[i], or of keys[i] only if values[i] is empty,
+  // concatenated.
+  virtual Results SortBatch(const std::vector<std::vector<uint32_t>>& keys,
+                            const std::vector<std::vector<uint32_t>>& values) {
+    return {};
+  }
+
+  // Sorts keys of each segment [segment_offsets[i], segment_offsets[i + 1]).
+  virtual Results SortSegmented(const std::vector<uint32_t>& keys,
+                                const std::vector<uint32_t>& segment_offsets) {
+    return {};
+  }
+
+  // Sorted keys, with original indices of the keys in values.
+  virtual Results Argsort(const std::vector<uint32_t>& keys) { return {}; }
+
+  // Key-value sort with values of value_words (2 or 4) consecutive uint32_t.
+  virtual Results SortKeyValueWide(const std::vector<uint32_t>& keys,
+                                   const std::vector<uint32_t>& values, uint32_t value_words) {
+    return {};
+  }
+
+  // Sorted keys, with each value stream permuted like keys, concatenated in values.
+  virtual Results SortKeyValueStreams(const std::vector<uint32_t>& keys,
+                                      const std::vector<std::vector<uint32_t>>& value_streams) {
+    return {};
+  }
+
+  // Records of record_words uint32_t, gathered by permutation in keys and scattered by it in
+  // values.
+  virtual Results GatherScatter(const std::vector<uint32_t>& records, uint32_t record_words,
+                                const std::vector<uint32_t>& permutation) {
+    return {};
+  }
+
+  // Records of record_words uint32_t sorted by the uint32_t key at key_word, stable.
+  virtual Results SortRecords(const std::vector<uint32_t>& records, uint32_t record_words,
+                              uint32_t key_word) {
+    return {};
+  }
+
+  // Out-of-place key-value sort. Empty keys if the inputs are not preserved.
+  virtual Results SortCopy(const std::vector<uint32_t>& keys, const std::vector<uint32_t>& values) {
+    return {};
+  }
+
+  // Key-value sort alternating between two caller buffers.
+  virtual Results SortPingPong(const std::vector<uint32_t>& keys,
+                               const std::vector<uint32_t>& values) {
+    return {};
+  }
+
+  // In-place key-value sort, which is not stable. Values of equal keys are sorted.
+  virtual Results SortInPlace(const std::vector<uint32_t>& keys,
+                              const std::vector<uint32_t>& values) {
+    return {};
+  }
+
+  // Hybrid MSD-first key-value sort, stable.
+  virtual Results SortHybrid(const std::vector<uint32_t>& keys,
+                             const std::vector<uint32_t>& values) {
+    return {};
+  }
+
+  // Key-value re-sort of nearly sorted keys, which is not stable. Values of equal keys are sorted.
+  virtual Results SortCoherent(const std::vector<uint32_t>& keys,
+                               const std::vector<uint32_t>& values) {
+    return {};
+  }
+
+  // Stable merge of sorted key-value arrays a and b. Among equal keys, a comes first.
+  virtual Results Merge(const std::vector<uint32_t>& a_keys, const std::vector<uint32_t>& a_values,
+                        const std::vector<uint32_t>& b_keys,
+                        const std::vector<uint32_t>& b_values) {
+    return {};
+  }
+
+  // Keys of a sorted set after inserting each batch, then erasing all keys in erase_keys.
+  virtual Results SortedSet(const std::vector<std::vector<uint32_t>>& insert_batches,
+                            const std::vector<uint32_t>& erase_keys) {
+    return {};
+  }
+
+  // The k smallest keys in ascending order, and the k-th smallest key, 0-based, in values.
+  virtual Results Select(const std::vector<uint32_t>& keys, uint32_t k) { return {}; }
+
+  // One key per run of equal sorted keys, with the value of the first element of the run.
+  virtual Results Unique(const std::vector<uint32_t>& keys, const std::vector<uint32_t>& values) {
+    return {};
+  }
+
+  // One key per run of equal sorted keys, with the length of the run in values.
+  virtual Results RunLengthEncode(const std::vector<uint32_t>& keys) { return {}; }
+
+  // One key per run of equal sorted keys, with sums of values of the run in values.
+  virtual Results ReduceByKey(const std::vector<uint32_t>& keys,
+                              const std::vector<uint32_t>& values) {
+    return {};
+  }
+
+  // Boundary table of keys after a sort by the top prefix_bits bits, 2^prefix_bits + 1 offsets
+  // in keys.
+  virtual Results SortBoundaries(const std::vector<uint32_t>& keys, uint32_t prefix_bits) {
+    return {};
+  }
+
+  // Lower bounds of queries in sorted keys, with upper bounds in values.
+  virtual Results Search(const std::vector<uint32_t>& keys, const std::vector<uint32_t>& queries) {
+    return {};
+  }
+
+  // (left index, right index) pairs of equal keys, ordered by left then right index, with left
+  // indices in keys and right indices in values.
+  virtual Results Join(const std::vector<uint32_t>& left_keys,
+                       const std::vector<uint32_t>& right_keys) {
+    return {};
+  }
+
+  // Counts of keys by bits [bit_offset, bit_offset + bit_count) in bucket_count buckets of equal
+  // width, returned in keys.
+  virtual Results Histogram(const std::vector<uint32_t>& keys, uint32_t bit_offset,
+                            uint32_t bit_count, uint32_t bucket_count) {
+    return {};
+  }
+
+  // Key-value pairs grouped by bits [bit_offset, bit_offset + bit_count) of keys, stable.
+  virtual Results Multisplit(const std::vector<uint32_t>& keys, const std::vector<uint32_t>& values,
+                             uint32_t bit_offset, uint32_t bit_count) {
+    return {};
+  }
 };
 
 #endif  // VK_RADIX_SORT_BENCHMARK_BASE_H
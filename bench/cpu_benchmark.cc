@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <chrono>
 #include <iostream>
+#include <numeric>
+#include <utility>
 
 namespace {
 
@@ -10,6 +12,29 @@ int64_t GetTimestamp() {
   return std::chrono::high_resolution_clock::now().time_since_epoch().count();
 }
 
+// Key-value pairs sorted by key, then by value, for sorts that are not stable.
+CpuBenchmark::Results SortPairs(const std::vector<uint32_t>& keys,
+                                const std::vector<uint32_t>& values) {
+  std::vector<std::pair<uint32_t, uint32_t>> pairs;
+  pairs.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) pairs.emplace_back(keys[i], values[i]);
+
+  auto start = GetTimestamp();
+  std::sort(pairs.begin(), pairs.end());
+  auto end = GetTimestamp();
+
+  CpuBenchmark::Results result;
+  result.keys.reserve(pairs.size());
+  result.values.reserve(pairs.size());
+  for (const auto& pair : pairs) {
+    result.keys.push_back(pair.first);
+    result.values.push_back(pair.second);
+  }
+  result.total_time = end - start;
+  result.cpu_time = result.total_time;
+  return result;
+}
+
 }  // namespace
 
 CpuBenchmark::CpuBenchmark() = default;
@@ -51,3 +76,386 @@ CpuBenchmark::Results CpuBenchmark::SortKeyValue(const std::vector<uint32_t>& ke
   result.cpu_time = result.total_time;
   return result;
 }
+
+CpuBenchmark::Results CpuBenchmark::ExclusiveScan(const std::vector<uint32_t>& values) {
+  Results result;
+  result.keys.resize(values.size());
+  auto start = GetTimestamp();
+  std::exclusive_scan(values.begin(), values.end(), result.keys.begin(), 0u);
+  auto end = GetTimestamp();
+  result.total_time = end - start;
+  result.cpu_time = result.total_time;
+  return result;
+}
+
+CpuBenchmark::Results CpuBenchmark::SortPlan(const std::vector<uint32_t>& keys,
+                                             const std::vector<uint32_t>& values) {
+  return SortKeyValue(keys, values);
+}
+
+CpuBenchmark::Results CpuBenchmark::SortBatch(const std::vector<std::vector<uint32_t>>& keys,
+                                              const std::vector<std::vector<uint32_t>>& values) {
+  Results result;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    Results sorted = values[i].empty() ? Sort(keys[i]) : SortKeyValue(keys[i], values[i]);
+    result.keys.insert(result.keys.end(), sorted.keys.begin(), sorted.keys.end());
+    result.values.insert(result.values.end(), sorted.values.begin(), sorted.values.end());
+    result.total_time += sorted.total_time;
+  }
+  result.cpu_time = result.total_time;
+  return result;
+}
+
+CpuBenchmark::Results CpuBenchmark::SortSegmented(const std::vector<uint32_t>& keys,
+                                                  const std::vector<uint32_t>& segment_offsets) {
+  Results result;
+  result.keys = keys;
+  auto start = GetTimestamp();
+  for (size_t i = 0; i + 1 < segment_offsets.size(); ++i) {
+    std::sort(result.keys.begin() + segment_offsets[i],
+              result.keys.begin() + segment_offsets[i + 1]);
+  }
+  auto end = GetTimestamp();
+  result.total_time = end - start;
+  result.cpu_time = result.total_time;
+  return result;
+}
+
+CpuBenchmark::Results CpuBenchmark::Argsort(const std::vector<uint32_t>& keys) {
+  std::vector<uint32_t> indices(keys.size());
+  std::iota(indices.begin(), indices.end(), 0u);
+  return SortKeyValue(keys, indices);
+}
+
+CpuBenchmark::Results CpuBenchmark::SortKeyValueWide(const std::vector<uint32_t>& keys,
+                                                     const std::vector<uint32_t>& values,
+                                                     uint32_t value_words) {
+  std::vector<uint32_t> indices(keys.size());
+  std::iota(indices.begin(), indices.end(), 0u);
+
+  auto start = GetTimestamp();
+  std::stable_sort(indices.begin(), indices.end(),
+                   [&](uint32_t lhs, uint32_t rhs) { return keys[lhs] < keys[rhs]; });
+  auto end = GetTimestamp();
+
+  Results result;
+  result.keys.reserve(keys.size());
+  result.values.reserve(values.size());
+  for (uint32_t index : indices) {
+    result.keys.push_back(keys[index]);
+    for (uint32_t j = 0; j < value_words; ++j) {
+      result.values.push_back(values[value_words * index + j]);
+    }
+  }
+  result.total_time = end - start;
+  result.cpu_time = result.total_time;
+  return result;
+}
+
+CpuBenchmark::Results CpuBenchmark::SortKeyValueStreams(
+    const std::vector<uint32_t>& keys, const std::vector<std::vector<uint32_t>>& value_streams) {
+  std::vector<uint32_t> indices(keys.size());
+  std::iota(indices.begin(), indices.end(), 0u);
+
+  auto start = GetTimestamp();
+  std::stable_sort(indices.begin(), indices.end(),
+                   [&](uint32_t lhs, uint32_t rhs) { return keys[lhs] < keys[rhs]; });
+  auto end = GetTimestamp();
+
+  Results result;
+  result.keys.reserve(keys.size());
+  for (uint32_t index : indices) result.keys.push_back(keys[index]);
+  for (const auto& stream : value_streams) {
+    for (uint32_t index : indices) result.values.push_back(stream[index]);
+  }
+  result.total_time = end - start;
+  result.cpu_time = result.total_time;
+  return result;
+}
+
+CpuBenchmark::Results CpuBenchmark::GatherScatter(const std::vector<uint32_t>& records,
+                                                  uint32_t record_words,
+                                                  const std::vector<uint32_t>& permutation) {
+  Results result;
+  result.keys.resize(records.size());
+  result.values.resize(records.size());
+  auto start = GetTimestamp();
+  for (size_t i = 0; i < permutation.size(); ++i) {
+    for (uint32_t j = 0; j < record_words; ++j) {
+      result.keys[record_words * i + j] = records[record_words * permutation[i] + j];
+      result.values[record_words * permutation[i] + j] = records[record_words * i + j];
+    }
+  }
+  auto end = GetTimestamp();
+  result.total_time = end - start;
+  result.cpu_time = result.total_time;
+  return result;
+}
+
+CpuBenchmark::Results CpuBenchmark::SortRecords(const std::vector<uint32_t>& records,
+                                                uint32_t record_words, uint32_t key_word) {
+  std::vector<uint32_t> indices(records.size() / record_words);
+  std::iota(indices.begin(), indices.end(), 0u);
+
+  auto start = GetTimestamp();
+  std::stable_sort(indices.begin(), indices.end(), [&](uint32_t lhs, uint32_t rhs) {
+    return records[record_words * lhs + key_word] < records[record_words * rhs + key_word];
+  });
+  auto end = GetTimestamp();
+
+  Results result;
+  result.keys.reserve(records.size());
+  for (uint32_t index : indices) {
+    for (uint32_t j = 0; j < record_words; ++j) {
+      result.keys.push_back(records[record_words * index + j]);
+    }
+  }
+  result.total_time = end - start;
+  result.cpu_time = result.total_time;
+  return result;
+}
+
+CpuBenchmark::Results CpuBenchmark::SortCopy(const std::vector<uint32_t>& keys,
+                                             const std::vector<uint32_t>& values) {
+  return SortKeyValue(keys, values);
+}
+
+CpuBenchmark::Results CpuBenchmark::SortPingPong(const std::vector<uint32_t>& keys,
+                                                 const std::vector<uint32_t>& values) {
+  return SortKeyValue(keys, values);
+}
+
+CpuBenchmark::Results CpuBenchmark::SortInPlace(const std::vector<uint32_t>& keys,
+                                                const std::vector<uint32_t>& values) {
+  return SortPairs(keys, values);
+}
+
+CpuBenchmark::Results CpuBenchmark::SortHybrid(const std::vector<uint32_t>& keys,
+                                               const std::vector<uint32_t>& values) {
+  return SortKeyValue(keys, values);
+}
+
+CpuBenchmark::Results CpuBenchmark::SortCoherent(const std::vector<uint32_t>& keys,
+                                                 const std::vector<uint32_t>& values) {
+  return SortPairs(keys, values);
+}
+
+CpuBenchmark::Results CpuBenchmark::Merge(const std::vector<uint32_t>& a_keys,
+                                          const std::vector<uint32_t>& a_values,
+                                          const std::vector<uint32_t>& b_keys,
+                                          const std::vector<uint32_t>& b_values) {
+  using Pair = std::pair<uint32_t, uint32_t>;
+  std::vector<Pair> a, b, merged(a_keys.size() + b_keys.size());
+  for (size_t i = 0; i < a_keys.size(); ++i) a.emplace_back(a_keys[i], a_values[i]);
+  for (size_t i = 0; i < b_keys.size(); ++i) b.emplace_back(b_keys[i], b_values[i]);
+
+  auto start = GetTimestamp();
+  std::merge(a.begin(), a.end(), b.begin(), b.end(), merged.begin(),
+             [](const Pair& lhs, const Pair& rhs) { return lhs.first < rhs.first; });
+  auto end = GetTimestamp();
+
+  Results result;
+  for (const Pair& pair : merged) {
+    result.keys.push_back(pair.first);
+    result.values.push_back(pair.second);
+  }
+  result.total_time = end - start;
+  result.cpu_time = result.total_time;
+  return result;
+}
+
+CpuBenchmark::Results CpuBenchmark::SortedSet(
+    const std::vector<std::vector<uint32_t>>& insert_batches,
+    const std::vector<uint32_t>& erase_keys) {
+  Results result;
+  auto start = GetTimestamp();
+  for (const auto& batch : insert_batches) {
+    result.keys.insert(result.keys.end(), batch.begin(), batch.end());
+  }
+  std::sort(result.keys.begin(), result.keys.end());
+
+  std::vector<uint32_t> erased = erase_keys;
+  std::sort(erased.begin(), erased.end());
+  result.keys.erase(std::remove_if(result.keys.begin(), result.keys.end(),
+                                   [&](uint32_t key) {
+                                     return std::binary_search(erased.begin(), erased.end(), key);
+                                   }),
+                    result.keys.end());
+  auto end = GetTimestamp();
+  result.total_time = end - start;
+  result.cpu_time = result.total_time;
+  return result;
+}
+
+CpuBenchmark::Results CpuBenchmark::Select(const std::vector<uint32_t>& keys, uint32_t k) {
+  k = std::min<uint32_t>(k, keys.size());
+
+  Results result;
+  result.keys = keys;
+  std::vector<uint32_t> nth = keys;
+  auto start = GetTimestamp();
+  std::partial_sort(result.keys.begin(), result.keys.begin() + k, result.keys.end());
+  result.keys.resize(k);
+  if (k < nth.size()) {
+    std::nth_element(nth.begin(), nth.begin() + k, nth.end());
+    result.values.push_back(nth[k]);
+  }
+  auto end = GetTimestamp();
+  result.total_time = end - start;
+  result.cpu_time = result.total_time;
+  return result;
+}
+
+CpuBenchmark::Results CpuBenchmark::Unique(const std::vector<uint32_t>& keys,
+                                           const std::vector<uint32_t>& values) {
+  Results result;
+  auto start = GetTimestamp();
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (i == 0 || keys[i] != keys[i - 1]) {
+      result.keys.push_back(keys[i]);
+      result.values.push_back(values[i]);
+    }
+  }
+  auto end = GetTimestamp();
+  result.total_time = end - start;
+  result.cpu_time = result.total_time;
+  return result;
+}
+
+CpuBenchmark::Results CpuBenchmark::RunLengthEncode(const std::vector<uint32_t>& keys) {
+  Results result;
+  auto start = GetTimestamp();
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (i == 0 || keys[i] != keys[i - 1]) {
+      result.keys.push_back(keys[i]);
+      result.values.push_back(0);
+    }
+    ++result.values.back();
+  }
+  auto end = GetTimestamp();
+  result.total_time = end - start;
+  result.cpu_time = result.total_time;
+  return result;
+}
+
+CpuBenchmark::Results CpuBenchmark::ReduceByKey(const std::vector<uint32_t>& keys,
+                                                const std::vector<uint32_t>& values) {
+  Results result;
+  auto start = GetTimestamp();
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (i == 0 || keys[i] != keys[i - 1]) {
+      result.keys.push_back(keys[i]);
+      result.values.push_back(0);
+    }
+    result.values.back() += values[i];
+  }
+  auto end = GetTimestamp();
+  result.total_time = end - start;
+  result.cpu_time = result.total_time;
+  return result;
+}
+
+CpuBenchmark::Results CpuBenchmark::SortBoundaries(const std::vector<uint32_t>& keys,
+                                                   uint32_t prefix_bits) {
+  std::vector<uint32_t> sorted = keys;
+  uint64_t prefix_count = uint64_t{1} << prefix_bits;
+
+  Results result;
+  result.keys.reserve(prefix_count + 1);
+  auto start = GetTimestamp();
+  std::sort(sorted.begin(), sorted.end());
+  for (uint64_t prefix = 0; prefix < prefix_count; ++prefix) {
+    uint32_t first_key = static_cast<uint32_t>(prefix << (32 - prefix_bits));
+    result.keys.push_back(std::lower_bound(sorted.begin(), sorted.end(), first_key) -
+                          sorted.begin());
+  }
+  result.keys.push_back(sorted.size());
+  auto end = GetTimestamp();
+  result.total_time = end - start;
+  result.cpu_time = result.total_time;
+  return result;
+}
+
+CpuBenchmark::Results CpuBenchmark::Search(const std::vector<uint32_t>& keys,
+                                           const std::vector<uint32_t>& queries) {
+  Results result;
+  result.keys.reserve(queries.size());
+  result.values.reserve(queries.size());
+  auto start = GetTimestamp();
+  for (uint32_t query : queries) {
+    result.keys.push_back(std::lower_bound(keys.begin(), keys.end(), query) - keys.begin());
+    result.values.push_back(std::upper_bound(keys.begin(), keys.end(), query) - keys.begin());
+  }
+  auto end = GetTimestamp();
+  result.total_time = end - start;
+  result.cpu_time = result.total_time;
+  return result;
+}
+
+CpuBenchmark::Results CpuBenchmark::Join(const std::vector<uint32_t>& left_keys,
+                                         const std::vector<uint32_t>& right_keys) {
+  using Pair = std::pair<uint32_t, uint32_t>;
+  std::vector<Pair> right;
+  right.reserve(right_keys.size());
+  for (uint32_t i = 0; i < right_keys.size(); ++i) right.emplace_back(right_keys[i], i);
+
+  Results result;
+  auto start = GetTimestamp();
+  // (key, index) pairs sorted by key, then index
+  std::sort(right.begin(), right.end());
+  for (uint32_t i = 0; i < left_keys.size(); ++i) {
+    auto first = std::lower_bound(right.begin(), right.end(), Pair{left_keys[i], 0u});
+    for (auto it = first; it != right.end() && it->first == left_keys[i]; ++it) {
+      result.keys.push_back(i);
+      result.values.push_back(it->second);
+    }
+  }
+  auto end = GetTimestamp();
+  result.total_time = end - start;
+  result.cpu_time = result.total_time;
+  return result;
+}
+
+CpuBenchmark::Results CpuBenchmark::Histogram(const std::vector<uint32_t>& keys,
+                                              uint32_t bit_offset, uint32_t bit_count,
+                                              uint32_t bucket_count) {
+  uint64_t digit_count = uint64_t{1} << bit_count;
+  uint64_t width = (digit_count + bucket_count - 1) / bucket_count;
+
+  Results result;
+  result.keys.resize(bucket_count);
+  auto start = GetTimestamp();
+  for (uint32_t key : keys) {
+    uint64_t digit = (key >> bit_offset) & (digit_count - 1);
+    ++result.keys[digit / width];
+  }
+  auto end = GetTimestamp();
+  result.total_time = end - start;
+  result.cpu_time = result.total_time;
+  return result;
+}
+
+CpuBenchmark::Results CpuBenchmark::Multisplit(const std::vector<uint32_t>& keys,
+                                               const std::vector<uint32_t>& values,
+                                               uint32_t bit_offset, uint32_t bit_count) {
+  uint32_t mask = (1u << bit_count) - 1;
+  std::vector<uint32_t> indices(keys.size());
+  std::iota(indices.begin(), indices.end(), 0u);
+
+  auto start = GetTimestamp();
+  std::stable_sort(indices.begin(), indices.end(), [&](uint32_t lhs, uint32_t rhs) {
+    return ((keys[lhs] >> bit_offset) & mask) < ((keys[rhs] >> bit_offset) & mask);
+  });
+  auto end = GetTimestamp();
+
+  Results result;
+  result.keys.reserve(keys.size());
+  result.values.reserve(keys.size());
+  for (uint32_t index : indices) {
+    result.keys.push_back(keys[index]);
+    result.values.push_back(values[index]);
+  }
+  result.total_time = end - start;
+  result.cpu_time = result.total_time;
+  return result;
+}
@@ -12,6 +12,52 @@ class CpuBenchmark : public BenchmarkBase {
   Results SortKeyValue(const std::vector<uint32_t>& keys,
                        const std::vector<uint32_t>& values) override;
 
+  Results ExclusiveScan(const std::vector<uint32_t>& values) override;
+
+  bool HasPrimitives() const override { return true; }
+  Results SortPlan(const std::vector<uint32_t>& keys,
+                   const std::vector<uint32_t>& values) override;
+  Results SortBatch(const std::vector<std::vector<uint32_t>>& keys,
+                    const std::vector<std::vector<uint32_t>>& values) override;
+  Results SortSegmented(const std::vector<uint32_t>& keys,
+                        const std::vector<uint32_t>& segment_offsets) override;
+  Results Argsort(const std::vector<uint32_t>& keys) override;
+  Results SortKeyValueWide(const std::vector<uint32_t>& keys, const std::vector<uint32_t>& values,
+                           uint32_t value_words) override;
+  Results SortKeyValueStreams(const std::vector<uint32_t>& keys,
+                              const std::vector<std::vector<uint32_t>>& value_streams) override;
+  Results GatherScatter(const std::vector<uint32_t>& records, uint32_t record_words,
+                        const std::vector<uint32_t>& permutation) override;
+  Results SortRecords(const std::vector<uint32_t>& records, uint32_t record_words,
+                      uint32_t key_word) override;
+  Results SortCopy(const std::vector<uint32_t>& keys,
+                   const std::vector<uint32_t>& values) override;
+  Results SortPingPong(const std::vector<uint32_t>& keys,
+                       const std::vector<uint32_t>& values) override;
+  Results SortInPlace(const std::vector<uint32_t>& keys,
+                      const std::vector<uint32_t>& values) override;
+  Results SortHybrid(const std::vector<uint32_t>& keys,
+                     const std::vector<uint32_t>& values) override;
+  Results SortCoherent(const std::vector<uint32_t>& keys,
+                       const std::vector<uint32_t>& values) override;
+  Results Merge(const std::vector<uint32_t>& a_keys, const std::vector<uint32_t>& a_values,
+                const std::vector<uint32_t>& b_keys,
+                const std::vector<uint32_t>& b_values) override;
+  Results SortedSet(const std::vector<std::vector<uint32_t>>& insert_batches,
+                    const std::vector<uint32_t>& erase_keys) override;
+  Results Select(const std::vector<uint32_t>& keys, uint32_t k) override;
+  Results Unique(const std::vector<uint32_t>& keys, const std::vector<uint32_t>& values) override;
+  Results RunLengthEncode(const std::vector<uint32_t>& keys) override;
+  Results ReduceByKey(const std::vector<uint32_t>& keys,
+                      const std::vector<uint32_t>& values) override;
+  Results SortBoundaries(const std::vector<uint32_t>& keys, uint32_t prefix_bits) override;
+  Results Search(const std::vector<uint32_t>& keys, const std::vector<uint32_t>& queries) override;
+  Results Join(const std::vector<uint32_t>& left_keys,
+               const std::vector<uint32_t>& right_keys) override;
+  Results Histogram(const std::vector<uint32_t>& keys, uint32_t bit_offset, uint32_t bit_count,
+                    uint32_t bucket_count) override;
+  Results Multisplit(const std::vector<uint32_t>& keys, const std::vector<uint32_t>& values,
+                     uint32_t bit_offset, uint32_t bit_count) override;
 };
 
 #endif  // VK_RADIX_SORT_CPU_BENCHMARK_H
@@ -1,8 +1,10 @@
 #include "vulkan_benchmark.h"
 
+#include <algorithm>
 #include <iostream>
 #include <cstring>
 #include <chrono>
+#include <utility>
 
 namespace {
 
@@ -10,6 +12,65 @@ uint32_t Align(uint32_t a, uint32_t b) { return (a + b - 1) / b * b; }
 
 constexpr auto timestamp_count = 15;
 
+constexpr VkBufferUsageFlags primitive_usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                               VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+                                               VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+// Consecutive uint32_t arrays in one buffer, at storage buffer offset alignment.
+class BufferLayout {
+ public:
+  explicit BufferLayout(uint32_t alignment) : alignment_(alignment) {}
+
+  VkDeviceSize Add(size_t count) {
+    VkDeviceSize offset = size_;
+    size_ += (count * sizeof(uint32_t) + alignment_ - 1) / alignment_ * alignment_;
+    return offset;
+  }
+
+  VkDeviceSize size() const { return std::max<VkDeviceSize>(size_, alignment_); }
+
+ private:
+  VkDeviceSize alignment_;
+  VkDeviceSize size_ = 0;
+};
+
+void Write(uint8_t* map, VkDeviceSize offset, const std::vector<uint32_t>& data) {
+  std::memcpy(map + offset, data.data(), data.size() * sizeof(uint32_t));
+}
+
+std::vector<uint32_t> Read(const uint8_t* map, VkDeviceSize offset, size_t count) {
+  std::vector<uint32_t> data(count);
+  std::memcpy(data.data(), map + offset, count * sizeof(uint32_t));
+  return data;
+}
+
+// Between commands of a primitive, which read outputs of the previous ones.
+void CmdBarrier(VkCommandBuffer command_buffer) {
+  VkMemoryBarrier2 barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
+  barrier.srcStageMask =
+      VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+  barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_SHADER_WRITE_BIT;
+  barrier.dstStageMask =
+      VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+  barrier.dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT |
+                          VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT;
+  VkDependencyInfo dependency = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+  dependency.memoryBarrierCount = 1;
+  dependency.pMemoryBarriers = &barrier;
+  vkCmdPipelineBarrier2(command_buffer, &dependency);
+}
+
+// Sorts values within runs of equal keys, to compare sorts that are not stable.
+void SortValuesOfEqualKeys(BenchmarkBase::Results* result) {
+  size_t begin = 0;
+  for (size_t i = 1; i <= result->keys.size(); ++i) {
+    if (i == result->keys.size() || result->keys[i] != result->keys[begin]) {
+      std::sort(result->values.begin() + begin, result->values.begin() + i);
+      begin = i;
+    }
+  }
+}
+
 static VKAPI_ATTR VkBool32 VKAPI_CALL
 DebugCallback(VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
               VkDebugUtilsMessageTypeFlagsEXT messageType,
@@ -197,10 +258,16 @@ VulkanBenchmark::VulkanBenchmark(bool validation) {
   query_pool_info.queryCount = timestamp_count;
   vkCreateQueryPool(device_, &query_pool_info, NULL, &query_pool_);
 
-  // sorter
+  // sorter, with a scratch pool for sorted sets
+  VrdxScratchPoolCreateInfo scratch_pool_info = {};
+  scratch_pool_info.pfnAllocate = AllocateScratchBuffer;
+  scratch_pool_info.pfnFree = FreeScratchBuffer;
+  scratch_pool_info.pUserData = this;
+
   VrdxSorterCreateInfo sorter_info = {};
   sorter_info.physicalDevice = physical_device_;
   sorter_info.device = device_;
+  sorter_info.pScratchPool = &scratch_pool_info;
   vrdxCreateSorter(&sorter_info, &sorter_);
 }
 
@@ -210,6 +277,10 @@ VulkanBenchmark::~VulkanBenchmark() {
   if (keys_.buffer) vmaDestroyBuffer(allocator_, keys_.buffer, keys_.allocation);
   if (storage_.buffer) vmaDestroyBuffer(allocator_, storage_.buffer, storage_.allocation);
   if (staging_.buffer) vmaDestroyBuffer(allocator_, staging_.buffer, staging_.allocation);
+  if (copy_.buffer) vmaDestroyBuffer(allocator_, copy_.buffer, copy_.allocation);
+  if (primitives_.buffer) {
+    vmaDestroyBuffer(allocator_, primitives_.buffer, primitives_.allocation);
+  }
 
   vrdxDestroySorter(sorter_);
   vkDestroyQueryPool(device_, query_pool_, NULL);
@@ -250,6 +321,66 @@ void VulkanBenchmark::Reallocate(Buffer* buffer, VkDeviceSize size, VkBufferUsag
   if (mapped) buffer->map = reinterpret_cast<uint8_t*>(allocation_info.pMappedData);
 }
 
+VkResult VulkanBenchmark::AllocateScratchBuffer(void* user_data, VkDeviceSize size,
+                                                VkBufferUsageFlags usage, VkBuffer* buffer) {
+  auto* benchmark = static_cast<VulkanBenchmark*>(user_data);
+
+  VkBufferCreateInfo buffer_info = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+  buffer_info.size = size;
+  buffer_info.usage = usage;
+  VmaAllocationCreateInfo allocation_create_info = {};
+  allocation_create_info.usage = VMA_MEMORY_USAGE_AUTO;
+
+  VmaAllocation allocation;
+  VkResult result = vmaCreateBuffer(benchmark->allocator_, &buffer_info, &allocation_create_info,
+                                    buffer, &allocation, NULL);
+  if (result == VK_SUCCESS) benchmark->scratch_allocations_[*buffer] = allocation;
+  return result;
+}
+
+void VulkanBenchmark::FreeScratchBuffer(void* user_data, VkBuffer buffer) {
+  auto* benchmark = static_cast<VulkanBenchmark*>(user_data);
+  auto it = benchmark->scratch_allocations_.find(buffer);
+  vmaDestroyBuffer(benchmark->allocator_, buffer, it->second);
+  benchmark->scratch_allocations_.erase(it);
+}
+
+void VulkanBenchmark::Execute(const std::function<void(VkCommandBuffer)>& record) {
+  vmaFlushAllocation(allocator_, primitives_.allocation, 0, VK_WHOLE_SIZE);
+
+  VkCommandBufferBeginInfo command_buffer_begin_info = {
+      VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+  command_buffer_begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+  vkBeginCommandBuffer(command_buffer_, &command_buffer_begin_info);
+
+  record(command_buffer_);
+
+  VkMemoryBarrier2 barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
+  barrier.srcStageMask =
+      VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+  barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_SHADER_WRITE_BIT;
+  barrier.dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT;
+  barrier.dstAccessMask = VK_ACCESS_2_HOST_READ_BIT;
+  VkDependencyInfo dependency = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+  dependency.memoryBarrierCount = 1;
+  dependency.pMemoryBarriers = &barrier;
+  vkCmdPipelineBarrier2(command_buffer_, &dependency);
+
+  vkEndCommandBuffer(command_buffer_);
+
+  VkSubmitInfo submit = {VK_STRUCTURE_TYPE_SUBMIT_INFO};
+  submit.commandBufferCount = 1;
+  submit.pCommandBuffers = &command_buffer_;
+  vkQueueSubmit(queue_, 1, &submit, fence_);
+  vkWaitForFences(device_, 1, &fence_, VK_TRUE, UINT64_MAX);
+  vkResetFences(device_, 1, &fence_);
+
+  // the GPU is done with all scratch
+  vrdxRecycleSorterScratch(sorter_, UINT64_MAX);
+
+  vmaInvalidateAllocation(allocator_, primitives_.allocation, 0, VK_WHOLE_SIZE);
+}
+
 VulkanBenchmark::Results VulkanBenchmark::Sort(const std::vector<uint32_t>& keys) {
   uint32_t element_count = keys.size();
   uint32_t inout_size = Align(element_count * sizeof(uint32_t), min_buffer_alignment_);
@@ -431,3 +562,916 @@ VulkanBenchmark::Results VulkanBenchmark::SortKeyValue(const std::vector<uint32_
   }
   return result;
 }
+
+VulkanBenchmark::Results VulkanBenchmark::ExclusiveScan(const std::vector<uint32_t>& values) {
+  uint32_t element_count = values.size();
+  uint32_t inout_size = Align(element_count * sizeof(uint32_t), min_buffer_alignment_);
+
+  Reallocate(&staging_, inout_size,
+             VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, true);
+  Reallocate(&keys_, inout_size,
+             VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+                 VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+  Reallocate(&copy_, inout_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+
+  VrdxSorterStorageRequirements requirements;
+  vrdxGetSorterScanStorageRequirements(sorter_, element_count, &requirements);
+  Reallocate(&storage_, requirements.size, requirements.usage);
+
+  std::memcpy(staging_.map, values.data(), element_count * sizeof(uint32_t));
+
+  VkCommandBufferBeginInfo command_buffer_begin_info = {
+      VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+  command_buffer_begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+  vkBeginCommandBuffer(command_buffer_, &command_buffer_begin_info);
+
+  vkCmdResetQueryPool(command_buffer_, query_pool_, 0, timestamp_count);
+
+  // copy to keys buffer
+  VkBufferCopy region = {};
+  region.srcOffset = 0;
+  region.dstOffset = 0;
+  region.size = element_count * sizeof(uint32_t);
+  vkCmdCopyBuffer(command_buffer_, staging_.buffer, keys_.buffer, 1, &region);
+
+  vkEndCommandBuffer(command_buffer_);
+
+  VkSubmitInfo submit = {VK_STRUCTURE_TYPE_SUBMIT_INFO};
+  submit.commandBufferCount = 1;
+  submit.pCommandBuffers = &command_buffer_;
+  vkQueueSubmit(queue_, 1, &submit, fence_);
+  vkWaitForFences(device_, 1, &fence_, VK_TRUE, UINT64_MAX);
+  vkResetFences(device_, 1, &fence_);
+
+  // copy of the same size as the bandwidth baseline, then scan in place
+  vkBeginCommandBuffer(command_buffer_, &command_buffer_begin_info);
+
+  vkCmdWriteTimestamp(command_buffer_, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, query_pool_, 0);
+  vkCmdCopyBuffer(command_buffer_, keys_.buffer, copy_.buffer, 1, &region);
+  vkCmdWriteTimestamp(command_buffer_, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, query_pool_, 1);
+
+  VkMemoryBarrier2 barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER_2};
+  barrier.srcStageMask = VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT;
+  barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
+  barrier.dstStageMask =
+      VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+  barrier.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT | VK_ACCESS_2_SHADER_WRITE_BIT;
+  VkDependencyInfo dependency = {VK_STRUCTURE_TYPE_DEPENDENCY_INFO};
+  dependency.memoryBarrierCount = 1;
+  dependency.pMemoryBarriers = &barrier;
+  vkCmdPipelineBarrier2(command_buffer_, &dependency);
+
+  vrdxCmdExclusiveScan(command_buffer_, sorter_, element_count, keys_.buffer, 0, keys_.buffer, 0,
+                       storage_.buffer, 0);
+  vkCmdWriteTimestamp(command_buffer_, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, query_pool_, 2);
+
+  vkEndCommandBuffer(command_buffer_);
+  auto cpu_start = std::chrono::steady_clock::now();
+  vkQueueSubmit(queue_, 1, &submit, fence_);
+  vkWaitForFences(device_, 1, &fence_, VK_TRUE, UINT64_MAX);
+  auto cpu_end = std::chrono::steady_clock::now();
+  vkResetFences(device_, 1, &fence_);
+
+  // copy back
+  vkBeginCommandBuffer(command_buffer_, &command_buffer_begin_info);
+
+  vkCmdCopyBuffer(command_buffer_, keys_.buffer, staging_.buffer, 1, &region);
+
+  vkEndCommandBuffer(command_buffer_);
+  vkQueueSubmit(queue_, 1, &submit, fence_);
+  vkWaitForFences(device_, 1, &fence_, VK_TRUE, UINT64_MAX);
+  vkResetFences(device_, 1, &fence_);
+
+  std::vector<uint64_t> timestamps(3);
+  vkGetQueryPoolResults(device_, query_pool_, 0, timestamps.size(),
+                        timestamps.size() * sizeof(uint64_t), timestamps.data(), sizeof(uint64_t),
+                        VK_QUERY_RESULT_64_BIT);
+
+  auto ticks_to_ns = [&](uint64_t ticks) -> uint64_t {
+    return static_cast<uint64_t>(ticks * timestamp_period_);
+  };
+
+  Results result;
+  result.keys.resize(element_count);
+  std::memcpy(result.keys.data(), staging_.map, element_count * sizeof(uint32_t));
+  result.total_time = ticks_to_ns(timestamps[2] - timestamps[1]);
+  result.copy_time = ticks_to_ns(timestamps[1] - timestamps[0]);
+  result.cpu_time =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(cpu_end - cpu_start).count();
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::SortPlan(const std::vector<uint32_t>& keys,
+                                                   const std::vector<uint32_t>& values) {
+  uint32_t element_count = keys.size();
+
+  BufferLayout layout(min_buffer_alignment_);
+  VkDeviceSize keys_offset = layout.Add(element_count);
+  VkDeviceSize values_offset = layout.Add(element_count);
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  Write(primitives_.map, keys_offset, keys);
+  Write(primitives_.map, values_offset, values);
+
+  VrdxSorterStorageRequirements requirements;
+  vrdxGetSorterKeyValueStorageRequirements(sorter_, element_count, &requirements);
+  Reallocate(&storage_, requirements.size, requirements.usage);
+
+  VrdxSortPlanCreateInfo plan_info = {};
+  plan_info.sorter = sorter_;
+  plan_info.maxElementCount = element_count;
+  plan_info.keysBuffer = primitives_.buffer;
+  plan_info.keysOffset = keys_offset;
+  plan_info.valuesBuffer = primitives_.buffer;
+  plan_info.valuesOffset = values_offset;
+  plan_info.storageBuffer = storage_.buffer;
+  VrdxSortPlan plan;
+  if (vrdxCreateSortPlan(&plan_info, &plan) != VK_SUCCESS) return {};
+
+  // the second execution sorts sorted keys, which a stable sort leaves in place
+  Execute([&](VkCommandBuffer command_buffer) {
+    vrdxCmdExecuteSortPlan(command_buffer, plan, element_count, VK_NULL_HANDLE, 0);
+    CmdBarrier(command_buffer);
+    vrdxCmdExecuteSortPlan(command_buffer, plan, element_count, VK_NULL_HANDLE, 0);
+  });
+  vrdxDestroySortPlan(plan);
+
+  Results result;
+  result.keys = Read(primitives_.map, keys_offset, element_count);
+  result.values = Read(primitives_.map, values_offset, element_count);
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::SortBatch(
+    const std::vector<std::vector<uint32_t>>& keys,
+    const std::vector<std::vector<uint32_t>>& values) {
+  // each sort has its own arrays and storage region
+  BufferLayout layout(min_buffer_alignment_);
+  VkDeviceSize storage_size = 0;
+  VkBufferUsageFlags storage_usage = 0;
+  std::vector<VrdxSortBatchInfo> sorts(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    uint32_t element_count = keys[i].size();
+    bool key_value = !values[i].empty();
+
+    VrdxSorterStorageRequirements requirements;
+    if (key_value) {
+      vrdxGetSorterKeyValueStorageRequirements(sorter_, element_count, &requirements);
+    } else {
+      vrdxGetSorterStorageRequirements(sorter_, element_count, &requirements);
+    }
+
+    sorts[i] = {};
+    sorts[i].elementCount = element_count;
+    sorts[i].keysOffset = layout.Add(element_count);
+    if (key_value) sorts[i].valuesOffset = layout.Add(element_count);
+    sorts[i].storageOffset = storage_size;
+    storage_size += Align(requirements.size, min_buffer_alignment_);
+    storage_usage |= requirements.usage;
+  }
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  Reallocate(&storage_, storage_size, storage_usage);
+
+  for (size_t i = 0; i < keys.size(); ++i) {
+    sorts[i].keysBuffer = primitives_.buffer;
+    if (!values[i].empty()) sorts[i].valuesBuffer = primitives_.buffer;
+    sorts[i].storageBuffer = storage_.buffer;
+    Write(primitives_.map, sorts[i].keysOffset, keys[i]);
+    Write(primitives_.map, sorts[i].valuesOffset, values[i]);
+  }
+
+  Execute([&](VkCommandBuffer command_buffer) {
+    vrdxCmdSortBatch(command_buffer, sorter_, sorts.size(), sorts.data(), VK_NULL_HANDLE, 0);
+  });
+
+  Results result;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    std::vector<uint32_t> sorted_keys = Read(primitives_.map, sorts[i].keysOffset, keys[i].size());
+    std::vector<uint32_t> sorted_values =
+        Read(primitives_.map, sorts[i].valuesOffset, values[i].size());
+    result.keys.insert(result.keys.end(), sorted_keys.begin(), sorted_keys.end());
+    result.values.insert(result.values.end(), sorted_values.begin(), sorted_values.end());
+  }
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::SortSegmented(
+    const std::vector<uint32_t>& keys, const std::vector<uint32_t>& segment_offsets) {
+  uint32_t element_count = keys.size();
+  uint32_t segment_count = segment_offsets.size() - 1;
+
+  BufferLayout layout(min_buffer_alignment_);
+  VkDeviceSize keys_offset = layout.Add(element_count);
+  VkDeviceSize segment_offsets_offset = layout.Add(segment_offsets.size());
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  Write(primitives_.map, keys_offset, keys);
+  Write(primitives_.map, segment_offsets_offset, segment_offsets);
+
+  VrdxSorterStorageRequirements requirements;
+  vrdxGetSorterSegmentedStorageRequirements(sorter_, element_count, segment_count, &requirements);
+  Reallocate(&storage_, requirements.size, requirements.usage);
+
+  Execute([&](VkCommandBuffer command_buffer) {
+    vrdxCmdSortSegmented(command_buffer, sorter_, element_count, segment_count,
+                         primitives_.buffer, segment_offsets_offset, primitives_.buffer,
+                         keys_offset, storage_.buffer, 0);
+  });
+
+  Results result;
+  result.keys = Read(primitives_.map, keys_offset, element_count);
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::Argsort(const std::vector<uint32_t>& keys) {
+  uint32_t element_count = keys.size();
+
+  BufferLayout layout(min_buffer_alignment_);
+  VkDeviceSize keys_offset = layout.Add(element_count);
+  VkDeviceSize indices_offset = layout.Add(element_count);
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  Write(primitives_.map, keys_offset, keys);
+
+  VrdxSorterStorageRequirements requirements;
+  vrdxGetSorterKeyValueStorageRequirements(sorter_, element_count, &requirements);
+  Reallocate(&storage_, requirements.size, requirements.usage);
+
+  Execute([&](VkCommandBuffer command_buffer) {
+    vrdxCmdArgsort(command_buffer, sorter_, element_count, primitives_.buffer, keys_offset,
+                   primitives_.buffer, indices_offset, storage_.buffer, 0, VK_NULL_HANDLE, 0);
+  });
+
+  Results result;
+  result.keys = Read(primitives_.map, keys_offset, element_count);
+  result.values = Read(primitives_.map, indices_offset, element_count);
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::SortKeyValueWide(const std::vector<uint32_t>& keys,
+                                                           const std::vector<uint32_t>& values,
+                                                           uint32_t value_words) {
+  uint32_t element_count = keys.size();
+
+  // values offset aligned to the value size
+  BufferLayout layout(std::max<uint32_t>(min_buffer_alignment_, 4 * sizeof(uint32_t)));
+  VkDeviceSize keys_offset = layout.Add(element_count);
+  VkDeviceSize values_offset = layout.Add(values.size());
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  Write(primitives_.map, keys_offset, keys);
+  Write(primitives_.map, values_offset, values);
+
+  VrdxSorterStorageRequirements requirements;
+  if (value_words == 2) {
+    vrdxGetSorterKeyValue64StorageRequirements(sorter_, element_count, &requirements);
+  } else {
+    vrdxGetSorterKeyValue128StorageRequirements(sorter_, element_count, &requirements);
+  }
+  Reallocate(&storage_, requirements.size, requirements.usage);
+
+  VkBuffer buffer = primitives_.buffer;
+  Execute([&](VkCommandBuffer command_buffer) {
+    if (value_words == 2) {
+      vrdxCmdSortKeyValue64(command_buffer, sorter_, element_count, buffer, keys_offset, buffer,
+                            values_offset, storage_.buffer, 0, VK_NULL_HANDLE, 0);
+    } else {
+      vrdxCmdSortKeyValue128(command_buffer, sorter_, element_count, buffer, keys_offset, buffer,
+                             values_offset, storage_.buffer, 0, VK_NULL_HANDLE, 0);
+    }
+  });
+
+  Results result;
+  result.keys = Read(primitives_.map, keys_offset, element_count);
+  result.values = Read(primitives_.map, values_offset, values.size());
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::SortKeyValueStreams(
+    const std::vector<uint32_t>& keys, const std::vector<std::vector<uint32_t>>& value_streams) {
+  uint32_t element_count = keys.size();
+  uint32_t stream_count = value_streams.size();
+  if (stream_count == 0 || stream_count > VRDX_MAX_VALUE_STREAMS) return {};
+
+  BufferLayout layout(min_buffer_alignment_);
+  VkDeviceSize keys_offset = layout.Add(element_count);
+  std::vector<VkDeviceSize> stream_offsets;
+  for (uint32_t i = 0; i < stream_count; ++i) stream_offsets.push_back(layout.Add(element_count));
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  Write(primitives_.map, keys_offset, keys);
+  for (uint32_t i = 0; i < stream_count; ++i) {
+    Write(primitives_.map, stream_offsets[i], value_streams[i]);
+  }
+
+  VrdxSorterStorageRequirements requirements;
+  vrdxGetSorterKeyValueStreamsStorageRequirements(sorter_, element_count, stream_count,
+                                                  &requirements);
+  Reallocate(&storage_, requirements.size, requirements.usage);
+
+  std::vector<VkBuffer> stream_buffers(stream_count, primitives_.buffer);
+  Execute([&](VkCommandBuffer command_buffer) {
+    vrdxCmdSortKeyValueStreams(command_buffer, sorter_, element_count, primitives_.buffer,
+                               keys_offset, stream_count, stream_buffers.data(),
+                               stream_offsets.data(), storage_.buffer, 0, VK_NULL_HANDLE, 0);
+  });
+
+  Results result;
+  result.keys = Read(primitives_.map, keys_offset, element_count);
+  for (uint32_t i = 0; i < stream_count; ++i) {
+    std::vector<uint32_t> stream = Read(primitives_.map, stream_offsets[i], element_count);
+    result.values.insert(result.values.end(), stream.begin(), stream.end());
+  }
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::GatherScatter(const std::vector<uint32_t>& records,
+                                                        uint32_t record_words,
+                                                        const std::vector<uint32_t>& permutation) {
+  uint32_t element_count = permutation.size();
+  uint32_t record_stride = record_words * sizeof(uint32_t);
+
+  // 16-byte aligned offsets, so records of 4 words are moved as uint4
+  BufferLayout layout(std::max<uint32_t>(min_buffer_alignment_, 4 * sizeof(uint32_t)));
+  VkDeviceSize permutation_offset = layout.Add(element_count);
+  VkDeviceSize records_offset = layout.Add(records.size());
+  VkDeviceSize gathered_offset = layout.Add(records.size());
+  VkDeviceSize scattered_offset = layout.Add(records.size());
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  Write(primitives_.map, permutation_offset, permutation);
+  Write(primitives_.map, records_offset, records);
+
+  VkBuffer buffer = primitives_.buffer;
+  Execute([&](VkCommandBuffer command_buffer) {
+    vrdxCmdGather(command_buffer, sorter_, element_count, buffer, permutation_offset,
+                  record_stride, buffer, records_offset, buffer, gathered_offset, VK_NULL_HANDLE,
+                  0);
+    vrdxCmdScatter(command_buffer, sorter_, element_count, buffer, permutation_offset,
+                   record_stride, buffer, records_offset, buffer, scattered_offset,
+                   VK_NULL_HANDLE, 0);
+  });
+
+  Results result;
+  result.keys = Read(primitives_.map, gathered_offset, records.size());
+  result.values = Read(primitives_.map, scattered_offset, records.size());
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::SortRecords(const std::vector<uint32_t>& records,
+                                                      uint32_t record_words, uint32_t key_word) {
+  uint32_t element_count = records.size() / record_words;
+  uint32_t record_stride = record_words * sizeof(uint32_t);
+
+  BufferLayout layout(min_buffer_alignment_);
+  VkDeviceSize records_offset = layout.Add(records.size());
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  Write(primitives_.map, records_offset, records);
+
+  VrdxSorterStorageRequirements requirements;
+  vrdxGetSorterRecordStorageRequirements(sorter_, element_count, record_stride, &requirements);
+  Reallocate(&storage_, requirements.size, requirements.usage);
+
+  Execute([&](VkCommandBuffer command_buffer) {
+    vrdxCmdSortRecords(command_buffer, sorter_, element_count, primitives_.buffer,
+                       records_offset, record_stride, key_word * sizeof(uint32_t),
+                       VRDX_KEY_TYPE_UINT32, storage_.buffer, 0, VK_NULL_HANDLE, 0);
+  });
+
+  Results result;
+  result.keys = Read(primitives_.map, records_offset, records.size());
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::SortCopy(const std::vector<uint32_t>& keys,
+                                                   const std::vector<uint32_t>& values) {
+  uint32_t element_count = keys.size();
+
+  BufferLayout layout(min_buffer_alignment_);
+  VkDeviceSize keys_offset = layout.Add(element_count);
+  VkDeviceSize values_offset = layout.Add(element_count);
+  VkDeviceSize output_keys_offset = layout.Add(element_count);
+  VkDeviceSize output_values_offset = layout.Add(element_count);
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  Write(primitives_.map, keys_offset, keys);
+  Write(primitives_.map, values_offset, values);
+
+  VrdxSorterStorageRequirements requirements;
+  vrdxGetSorterCopyKeyValueStorageRequirements(sorter_, element_count, &requirements);
+  Reallocate(&storage_, requirements.size, requirements.usage);
+
+  VkBuffer buffer = primitives_.buffer;
+  Execute([&](VkCommandBuffer command_buffer) {
+    vrdxCmdSortCopyKeyValue(command_buffer, sorter_, element_count, buffer, keys_offset, buffer,
+                            values_offset, buffer, output_keys_offset, buffer,
+                            output_values_offset, storage_.buffer, 0, VK_NULL_HANDLE, 0);
+  });
+
+  if (Read(primitives_.map, keys_offset, element_count) != keys ||
+      Read(primitives_.map, values_offset, element_count) != values) {
+    return {};
+  }
+
+  Results result;
+  result.keys = Read(primitives_.map, output_keys_offset, element_count);
+  result.values = Read(primitives_.map, output_values_offset, element_count);
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::SortPingPong(const std::vector<uint32_t>& keys,
+                                                       const std::vector<uint32_t>& values) {
+  uint32_t element_count = keys.size();
+
+  BufferLayout layout(min_buffer_alignment_);
+  VkDeviceSize keys_offsets[2] = {layout.Add(element_count), layout.Add(element_count)};
+  VkDeviceSize values_offsets[2] = {layout.Add(element_count), layout.Add(element_count)};
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  Write(primitives_.map, keys_offsets[0], keys);
+  Write(primitives_.map, values_offsets[0], values);
+
+  VrdxSorterStorageRequirements requirements;
+  vrdxGetSorterPingPongStorageRequirements(sorter_, element_count, &requirements);
+  Reallocate(&storage_, requirements.size, requirements.usage);
+
+  VkBuffer buffer = primitives_.buffer;
+  VrdxSortResultBuffer result_buffer;
+  Execute([&](VkCommandBuffer command_buffer) {
+    vrdxCmdSortPingPongKeyValue(command_buffer, sorter_, element_count, buffer, keys_offsets[0],
+                                buffer, keys_offsets[1], buffer, values_offsets[0], buffer,
+                                values_offsets[1], storage_.buffer, 0, VK_NULL_HANDLE, 0,
+                                &result_buffer);
+  });
+
+  int index = result_buffer == VRDX_SORT_RESULT_BUFFER_A ? 0 : 1;
+  Results result;
+  result.keys = Read(primitives_.map, keys_offsets[index], element_count);
+  result.values = Read(primitives_.map, values_offsets[index], element_count);
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::SortInPlace(const std::vector<uint32_t>& keys,
+                                                      const std::vector<uint32_t>& values) {
+  uint32_t element_count = keys.size();
+
+  BufferLayout layout(min_buffer_alignment_);
+  VkDeviceSize keys_offset = layout.Add(element_count);
+  VkDeviceSize values_offset = layout.Add(element_count);
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  Write(primitives_.map, keys_offset, keys);
+  Write(primitives_.map, values_offset, values);
+
+  VrdxSorterStorageRequirements requirements;
+  vrdxGetSorterInPlaceStorageRequirements(sorter_, element_count, &requirements);
+  Reallocate(&storage_, requirements.size, requirements.usage);
+
+  VkBuffer buffer = primitives_.buffer;
+  Execute([&](VkCommandBuffer command_buffer) {
+    vrdxCmdSortInPlaceKeyValue(command_buffer, sorter_, element_count, buffer, keys_offset, buffer,
+                               values_offset, storage_.buffer, 0);
+  });
+
+  Results result;
+  result.keys = Read(primitives_.map, keys_offset, element_count);
+  result.values = Read(primitives_.map, values_offset, element_count);
+  SortValuesOfEqualKeys(&result);
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::SortHybrid(const std::vector<uint32_t>& keys,
+                                                     const std::vector<uint32_t>& values) {
+  uint32_t element_count = keys.size();
+
+  BufferLayout layout(min_buffer_alignment_);
+  VkDeviceSize keys_offset = layout.Add(element_count);
+  VkDeviceSize values_offset = layout.Add(element_count);
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  Write(primitives_.map, keys_offset, keys);
+  Write(primitives_.map, values_offset, values);
+
+  VrdxSorterStorageRequirements requirements;
+  vrdxGetSorterHybridKeyValueStorageRequirements(sorter_, element_count, &requirements);
+  Reallocate(&storage_, requirements.size, requirements.usage);
+
+  VkBuffer buffer = primitives_.buffer;
+  Execute([&](VkCommandBuffer command_buffer) {
+    vrdxCmdSortHybridKeyValue(command_buffer, sorter_, element_count, buffer, keys_offset, buffer,
+                              values_offset, storage_.buffer, 0);
+  });
+
+  Results result;
+  result.keys = Read(primitives_.map, keys_offset, element_count);
+  result.values = Read(primitives_.map, values_offset, element_count);
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::SortCoherent(const std::vector<uint32_t>& keys,
+                                                       const std::vector<uint32_t>& values) {
+  uint32_t element_count = keys.size();
+
+  BufferLayout layout(min_buffer_alignment_);
+  VkDeviceSize keys_offset = layout.Add(element_count);
+  VkDeviceSize values_offset = layout.Add(element_count);
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  Write(primitives_.map, keys_offset, keys);
+  Write(primitives_.map, values_offset, values);
+
+  VrdxSorterStorageRequirements requirements;
+  vrdxGetSorterCoherentKeyValueStorageRequirements(sorter_, element_count, &requirements);
+  Reallocate(&storage_, requirements.size, requirements.usage);
+
+  VkBuffer buffer = primitives_.buffer;
+  Execute([&](VkCommandBuffer command_buffer) {
+    vrdxCmdSortCoherentKeyValue(command_buffer, sorter_, element_count, buffer, keys_offset, buffer,
+                                values_offset, storage_.buffer, 0);
+  });
+
+  Results result;
+  result.keys = Read(primitives_.map, keys_offset, element_count);
+  result.values = Read(primitives_.map, values_offset, element_count);
+  SortValuesOfEqualKeys(&result);
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::Merge(const std::vector<uint32_t>& a_keys,
+                                                const std::vector<uint32_t>& a_values,
+                                                const std::vector<uint32_t>& b_keys,
+                                                const std::vector<uint32_t>& b_values) {
+  uint32_t count_a = a_keys.size();
+  uint32_t count_b = b_keys.size();
+
+  BufferLayout layout(min_buffer_alignment_);
+  VkDeviceSize a_keys_offset = layout.Add(count_a);
+  VkDeviceSize a_values_offset = layout.Add(count_a);
+  VkDeviceSize b_keys_offset = layout.Add(count_b);
+  VkDeviceSize b_values_offset = layout.Add(count_b);
+  VkDeviceSize output_keys_offset = layout.Add(count_a + count_b);
+  VkDeviceSize output_values_offset = layout.Add(count_a + count_b);
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  Write(primitives_.map, a_keys_offset, a_keys);
+  Write(primitives_.map, a_values_offset, a_values);
+  Write(primitives_.map, b_keys_offset, b_keys);
+  Write(primitives_.map, b_values_offset, b_values);
+
+  VkBuffer buffer = primitives_.buffer;
+  Execute([&](VkCommandBuffer command_buffer) {
+    vrdxCmdMergeKeyValue(command_buffer, sorter_, count_a, buffer, a_keys_offset, buffer,
+                         a_values_offset, count_b, buffer, b_keys_offset, buffer, b_values_offset,
+                         buffer, output_keys_offset, buffer, output_values_offset);
+  });
+
+  Results result;
+  result.keys = Read(primitives_.map, output_keys_offset, count_a + count_b);
+  result.values = Read(primitives_.map, output_values_offset, count_a + count_b);
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::SortedSet(
+    const std::vector<std::vector<uint32_t>>& insert_batches,
+    const std::vector<uint32_t>& erase_keys) {
+  VrdxSortedSetCreateInfo set_info = {};
+  set_info.sorter = sorter_;
+  VrdxSortedSet set;
+  if (vrdxCreateSortedSet(&set_info, &set) != VK_SUCCESS) return {};
+
+  BufferLayout layout(min_buffer_alignment_);
+  std::vector<VkDeviceSize> batch_offsets;
+  uint32_t max_count = 0;
+  for (const auto& batch : insert_batches) {
+    batch_offsets.push_back(layout.Add(batch.size()));
+    max_count += batch.size();
+  }
+  VkDeviceSize erase_keys_offset = layout.Add(erase_keys.size());
+  VkDeviceSize output_keys_offset = layout.Add(max_count);
+  VkDeviceSize count_offset = layout.Add(1);
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  for (size_t i = 0; i < insert_batches.size(); ++i) {
+    Write(primitives_.map, batch_offsets[i], insert_batches[i]);
+  }
+  Write(primitives_.map, erase_keys_offset, erase_keys);
+
+  VkResult result = VK_SUCCESS;
+  Execute([&](VkCommandBuffer command_buffer) {
+    for (size_t i = 0; i < insert_batches.size() && result == VK_SUCCESS; ++i) {
+      result = vrdxCmdSortedSetInsert(command_buffer, set, insert_batches[i].size(),
+                                      primitives_.buffer, batch_offsets[i], VK_NULL_HANDLE, 0);
+      CmdBarrier(command_buffer);
+    }
+    if (result == VK_SUCCESS) {
+      result = vrdxCmdSortedSetErase(command_buffer, set, erase_keys.size(), primitives_.buffer,
+                                     erase_keys_offset);
+      CmdBarrier(command_buffer);
+    }
+
+    // the count on GPU is at most max_count
+    VrdxSortedSetBuffers buffers;
+    vrdxGetSortedSetBuffers(set, &buffers);
+    VkBufferCopy regions[2] = {{0, output_keys_offset, max_count * sizeof(uint32_t)},
+                               {buffers.countOffset, count_offset, sizeof(uint32_t)}};
+    if (max_count > 0) {
+      vkCmdCopyBuffer(command_buffer, buffers.keysBuffer, primitives_.buffer, 1, &regions[0]);
+    }
+    vkCmdCopyBuffer(command_buffer, buffers.countBuffer, primitives_.buffer, 1, &regions[1]);
+  });
+  vrdxDestroySortedSet(set);
+  if (result != VK_SUCCESS) return {};
+
+  uint32_t count;
+  std::memcpy(&count, primitives_.map + count_offset, sizeof(uint32_t));
+
+  Results results;
+  results.keys = Read(primitives_.map, output_keys_offset, count);
+  return results;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::Select(const std::vector<uint32_t>& keys, uint32_t k) {
+  uint32_t element_count = keys.size();
+  k = std::min(k, element_count);
+
+  BufferLayout layout(min_buffer_alignment_);
+  VkDeviceSize keys_offset = layout.Add(element_count);
+  VkDeviceSize output_keys_offset = layout.Add(k);
+  VkDeviceSize nth_offset = layout.Add(1);
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  Write(primitives_.map, keys_offset, keys);
+
+  VrdxSorterStorageRequirements requirements;
+  vrdxGetSorterSelectStorageRequirements(sorter_, &requirements);
+  Reallocate(&storage_, requirements.size, requirements.usage);
+
+  Execute([&](VkCommandBuffer command_buffer) {
+    vrdxCmdSelectTopK(command_buffer, sorter_, element_count, k, primitives_.buffer, keys_offset,
+                      primitives_.buffer, output_keys_offset, storage_.buffer, 0);
+    // both commands use the same storage
+    CmdBarrier(command_buffer);
+    vrdxCmdNthElement(command_buffer, sorter_, element_count, k, primitives_.buffer, keys_offset,
+                      primitives_.buffer, nth_offset, storage_.buffer, 0);
+  });
+
+  // top k keys are in unspecified order
+  Results result;
+  result.keys = Read(primitives_.map, output_keys_offset, k);
+  std::sort(result.keys.begin(), result.keys.end());
+  if (k < element_count) result.values = Read(primitives_.map, nth_offset, 1);
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::Unique(const std::vector<uint32_t>& keys,
+                                                 const std::vector<uint32_t>& values) {
+  uint32_t element_count = keys.size();
+
+  BufferLayout layout(min_buffer_alignment_);
+  VkDeviceSize keys_offset = layout.Add(element_count);
+  VkDeviceSize values_offset = layout.Add(element_count);
+  VkDeviceSize output_keys_offset = layout.Add(element_count);
+  VkDeviceSize output_values_offset = layout.Add(element_count);
+  VkDeviceSize count_offset = layout.Add(1);
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  Write(primitives_.map, keys_offset, keys);
+  Write(primitives_.map, values_offset, values);
+
+  VrdxSorterStorageRequirements requirements;
+  vrdxGetSorterRunStorageRequirements(sorter_, element_count, &requirements);
+  Reallocate(&storage_, requirements.size, requirements.usage);
+
+  VkBuffer buffer = primitives_.buffer;
+  Execute([&](VkCommandBuffer command_buffer) {
+    vrdxCmdUniqueKeyValue(command_buffer, sorter_, element_count, buffer, keys_offset, buffer,
+                          values_offset, buffer, output_keys_offset, buffer, output_values_offset,
+                          buffer, count_offset, storage_.buffer, 0);
+  });
+
+  uint32_t count;
+  std::memcpy(&count, primitives_.map + count_offset, sizeof(uint32_t));
+
+  Results result;
+  result.keys = Read(primitives_.map, output_keys_offset, count);
+  result.values = Read(primitives_.map, output_values_offset, count);
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::RunLengthEncode(const std::vector<uint32_t>& keys) {
+  uint32_t element_count = keys.size();
+
+  BufferLayout layout(min_buffer_alignment_);
+  VkDeviceSize keys_offset = layout.Add(element_count);
+  VkDeviceSize output_keys_offset = layout.Add(element_count);
+  VkDeviceSize output_counts_offset = layout.Add(element_count);
+  VkDeviceSize count_offset = layout.Add(1);
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  Write(primitives_.map, keys_offset, keys);
+
+  VrdxSorterStorageRequirements requirements;
+  vrdxGetSorterRunStorageRequirements(sorter_, element_count, &requirements);
+  Reallocate(&storage_, requirements.size, requirements.usage);
+
+  VkBuffer buffer = primitives_.buffer;
+  Execute([&](VkCommandBuffer command_buffer) {
+    vrdxCmdRunLengthEncode(command_buffer, sorter_, element_count, buffer, keys_offset, buffer,
+                           output_keys_offset, buffer, output_counts_offset, buffer, count_offset,
+                           storage_.buffer, 0);
+  });
+
+  uint32_t count;
+  std::memcpy(&count, primitives_.map + count_offset, sizeof(uint32_t));
+
+  Results result;
+  result.keys = Read(primitives_.map, output_keys_offset, count);
+  result.values = Read(primitives_.map, output_counts_offset, count);
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::ReduceByKey(const std::vector<uint32_t>& keys,
+                                                      const std::vector<uint32_t>& values) {
+  uint32_t element_count = keys.size();
+
+  BufferLayout layout(min_buffer_alignment_);
+  VkDeviceSize keys_offset = layout.Add(element_count);
+  VkDeviceSize values_offset = layout.Add(element_count);
+  VkDeviceSize output_keys_offset = layout.Add(element_count);
+  VkDeviceSize output_values_offset = layout.Add(element_count);
+  VkDeviceSize count_offset = layout.Add(1);
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  Write(primitives_.map, keys_offset, keys);
+  Write(primitives_.map, values_offset, values);
+
+  VrdxSorterStorageRequirements requirements;
+  vrdxGetSorterRunStorageRequirements(sorter_, element_count, &requirements);
+  Reallocate(&storage_, requirements.size, requirements.usage);
+
+  VkBuffer buffer = primitives_.buffer;
+  Execute([&](VkCommandBuffer command_buffer) {
+    vrdxCmdReduceByKey(command_buffer, sorter_, element_count, VRDX_REDUCE_OP_SUM, buffer,
+                       keys_offset, buffer, values_offset, buffer, output_keys_offset, buffer,
+                       output_values_offset, buffer, count_offset, storage_.buffer, 0);
+  });
+
+  uint32_t count;
+  std::memcpy(&count, primitives_.map + count_offset, sizeof(uint32_t));
+
+  Results result;
+  result.keys = Read(primitives_.map, output_keys_offset, count);
+  result.values = Read(primitives_.map, output_values_offset, count);
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::SortBoundaries(const std::vector<uint32_t>& keys,
+                                                         uint32_t prefix_bits) {
+  uint32_t element_count = keys.size();
+  uint32_t boundary_count = (1u << prefix_bits) + 1;
+
+  BufferLayout layout(min_buffer_alignment_);
+  VkDeviceSize keys_offset = layout.Add(element_count);
+  VkDeviceSize boundaries_offset = layout.Add(boundary_count);
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  Write(primitives_.map, keys_offset, keys);
+
+  VrdxSorterStorageRequirements requirements;
+  vrdxGetSorterStorageRequirements(sorter_, element_count, &requirements);
+  Reallocate(&storage_, requirements.size, requirements.usage);
+
+  VkBuffer buffer = primitives_.buffer;
+  Execute([&](VkCommandBuffer command_buffer) {
+    vrdxCmdSort(command_buffer, sorter_, element_count, buffer, keys_offset, storage_.buffer, 0,
+                VK_NULL_HANDLE, 0);
+    CmdBarrier(command_buffer);
+    vrdxCmdSortBoundaries(command_buffer, sorter_, element_count, prefix_bits, buffer,
+                          keys_offset, storage_.buffer, 0, buffer, boundaries_offset);
+  });
+
+  Results result;
+  result.keys = Read(primitives_.map, boundaries_offset, boundary_count);
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::Search(const std::vector<uint32_t>& keys,
+                                                 const std::vector<uint32_t>& queries) {
+  uint32_t key_count = keys.size();
+  uint32_t query_count = queries.size();
+
+  BufferLayout layout(min_buffer_alignment_);
+  VkDeviceSize keys_offset = layout.Add(key_count);
+  VkDeviceSize queries_offset = layout.Add(query_count);
+  VkDeviceSize lower_offset = layout.Add(query_count);
+  VkDeviceSize upper_offset = layout.Add(query_count);
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  Write(primitives_.map, keys_offset, keys);
+  Write(primitives_.map, queries_offset, queries);
+
+  VkBuffer buffer = primitives_.buffer;
+  Execute([&](VkCommandBuffer command_buffer) {
+    vrdxCmdLowerBound(command_buffer, sorter_, key_count, buffer, keys_offset, query_count, buffer,
+                      queries_offset, VK_FALSE, buffer, lower_offset);
+    vrdxCmdUpperBound(command_buffer, sorter_, key_count, buffer, keys_offset, query_count, buffer,
+                      queries_offset, VK_FALSE, buffer, upper_offset);
+  });
+
+  Results result;
+  result.keys = Read(primitives_.map, lower_offset, query_count);
+  result.values = Read(primitives_.map, upper_offset, query_count);
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::Join(const std::vector<uint32_t>& left_keys,
+                                               const std::vector<uint32_t>& right_keys) {
+  uint32_t left_count = left_keys.size();
+  uint32_t right_count = right_keys.size();
+
+  VrdxSorterStorageRequirements requirements;
+  vrdxGetSorterSortMergeJoinStorageRequirements(sorter_, left_count, right_count, &requirements);
+  Reallocate(&storage_, requirements.size, requirements.usage);
+
+  // joined again with more room if the first guess is too small. The pair count saturates at
+  // max_pair_count + 1, so room at least doubles.
+  uint32_t max_pair_count = left_count + right_count;
+  uint32_t counts[2];
+  VkDeviceSize pairs_offset;
+  while (true) {
+    BufferLayout layout(min_buffer_alignment_);
+    VkDeviceSize left_keys_offset = layout.Add(left_count);
+    VkDeviceSize left_indices_offset = layout.Add(left_count);
+    VkDeviceSize right_keys_offset = layout.Add(right_count);
+    VkDeviceSize right_indices_offset = layout.Add(right_count);
+    VkDeviceSize count_offset = layout.Add(2);
+    pairs_offset = layout.Add(2 * static_cast<size_t>(max_pair_count));
+    Reallocate(&primitives_, layout.size(), primitive_usage, true);
+    Write(primitives_.map, left_keys_offset, left_keys);
+    Write(primitives_.map, right_keys_offset, right_keys);
+
+    VkBuffer buffer = primitives_.buffer;
+    Execute([&](VkCommandBuffer command_buffer) {
+      vrdxCmdSortMergeJoin(command_buffer, sorter_, left_count, buffer, left_keys_offset, buffer,
+                           left_indices_offset, right_count, buffer, right_keys_offset, buffer,
+                           right_indices_offset, max_pair_count, buffer, pairs_offset, buffer,
+                           count_offset, storage_.buffer, 0);
+    });
+
+    std::memcpy(counts, primitives_.map + count_offset, sizeof(counts));
+    if (counts[1] <= max_pair_count) break;
+    max_pair_count = std::max(counts[1], 2 * max_pair_count);
+  }
+
+  std::vector<uint32_t> pairs = Read(primitives_.map, pairs_offset, 2 * counts[0]);
+  std::vector<std::pair<uint32_t, uint32_t>> sorted_pairs;
+  sorted_pairs.reserve(counts[0]);
+  for (uint32_t i = 0; i < counts[0]; ++i) {
+    sorted_pairs.emplace_back(pairs[2 * i], pairs[2 * i + 1]);
+  }
+  std::sort(sorted_pairs.begin(), sorted_pairs.end());
+
+  Results result;
+  result.keys.reserve(counts[0]);
+  result.values.reserve(counts[0]);
+  for (const auto& pair : sorted_pairs) {
+    result.keys.push_back(pair.first);
+    result.values.push_back(pair.second);
+  }
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::Histogram(const std::vector<uint32_t>& keys,
+                                                    uint32_t bit_offset, uint32_t bit_count,
+                                                    uint32_t bucket_count) {
+  uint32_t element_count = keys.size();
+
+  BufferLayout layout(min_buffer_alignment_);
+  VkDeviceSize keys_offset = layout.Add(element_count);
+  VkDeviceSize histogram_offset = layout.Add(bucket_count);
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  Write(primitives_.map, keys_offset, keys);
+
+  Execute([&](VkCommandBuffer command_buffer) {
+    vrdxCmdHistogram(command_buffer, sorter_, element_count, primitives_.buffer, keys_offset,
+                     bit_offset, bit_count, bucket_count, primitives_.buffer, histogram_offset);
+  });
+
+  Results result;
+  result.keys = Read(primitives_.map, histogram_offset, bucket_count);
+  return result;
+}
+
+VulkanBenchmark::Results VulkanBenchmark::Multisplit(const std::vector<uint32_t>& keys,
+                                                     const std::vector<uint32_t>& values,
+                                                     uint32_t bit_offset, uint32_t bit_count) {
+  uint32_t element_count = keys.size();
+
+  BufferLayout layout(min_buffer_alignment_);
+  VkDeviceSize keys_offset = layout.Add(element_count);
+  VkDeviceSize values_offset = layout.Add(element_count);
+  VkDeviceSize output_keys_offset = layout.Add(element_count);
+  VkDeviceSize output_values_offset = layout.Add(element_count);
+  VkDeviceSize bucket_offsets_offset = layout.Add(256);  // RADIX
+  Reallocate(&primitives_, layout.size(), primitive_usage, true);
+  Write(primitives_.map, keys_offset, keys);
+  Write(primitives_.map, values_offset, values);
+
+  VrdxSorterStorageRequirements requirements;
+  vrdxGetSorterMultisplitStorageRequirements(sorter_, element_count, &requirements);
+  Reallocate(&storage_, requirements.size, requirements.usage);
+
+  VkBuffer buffer = primitives_.buffer;
+  Execute([&](VkCommandBuffer command_buffer) {
+    vrdxCmdMultisplitKeyValue(command_buffer, sorter_, element_count, bit_offset, bit_count,
+                              buffer, keys_offset, buffer, values_offset, buffer,
+                              output_keys_offset, buffer, output_values_offset, buffer,
+                              bucket_offsets_offset, storage_.buffer, 0);
+  });
+
+  Results result;
+  result.keys = Read(primitives_.map, output_keys_offset, element_count);
+  result.values = Read(primitives_.map, output_values_offset, element_count);
+  return result;
+}
@@ -1,6 +1,9 @@
 #ifndef VK_RADIX_SORT_VULKAN_BENCHMARK_H
 #define VK_RADIX_SORT_VULKAN_BENCHMARK_H
 
+#include <functional>
+#include <unordered_map>
+
 #include "benchmark_base.h"
 
 #include "volk.h"
@@ -26,10 +29,64 @@ class VulkanBenchmark : public BenchmarkBase {
   Results Sort(const std::vector<uint32_t>& keys) override;
   Results SortKeyValue(const std::vector<uint32_t>& keys,
                        const std::vector<uint32_t>& values) override;
+  Results ExclusiveScan(const std::vector<uint32_t>& values) override;
+
+  bool HasPrimitives() const override { return true; }
+  Results SortPlan(const std::vector<uint32_t>& keys,
+                   const std::vector<uint32_t>& values) override;
+  Results SortBatch(const std::vector<std::vector<uint32_t>>& keys,
+                    const std::vector<std::vector<uint32_t>>& values) override;
+  Results SortSegmented(const std::vector<uint32_t>& keys,
+                        const std::vector<uint32_t>& segment_offsets) override;
+  Results Argsort(const std::vector<uint32_t>& keys) override;
+  Results SortKeyValueWide(const std::vector<uint32_t>& keys, const std::vector<uint32_t>& values,
+                           uint32_t value_words) override;
+  Results SortKeyValueStreams(const std::vector<uint32_t>& keys,
+                              const std::vector<std::vector<uint32_t>>& value_streams) override;
+  Results GatherScatter(const std::vector<uint32_t>& records, uint32_t record_words,
+                        const std::vector<uint32_t>& permutation) override;
+  Results SortRecords(const std::vector<uint32_t>& records, uint32_t record_words,
+                      uint32_t key_word) override;
+  Results SortCopy(const std::vector<uint32_t>& keys,
+                   const std::vector<uint32_t>& values) override;
+  Results SortPingPong(const std::vector<uint32_t>& keys,
+                       const std::vector<uint32_t>& values) override;
+  Results SortInPlace(const std::vector<uint32_t>& keys,
+                      const std::vector<uint32_t>& values) override;
+  Results SortHybrid(const std::vector<uint32_t>& keys,
+                     const std::vector<uint32_t>& values) override;
+  Results SortCoherent(const std::vector<uint32_t>& keys,
+                       const std::vector<uint32_t>& values) override;
+  Results Merge(const std::vector<uint32_t>& a_keys, const std::vector<uint32_t>& a_values,
+                const std::vector<uint32_t>& b_keys,
+                const std::vector<uint32_t>& b_values) override;
+  Results SortedSet(const std::vector<std::vector<uint32_t>>& insert_batches,
+                    const std::vector<uint32_t>& erase_keys) override;
+  Results Select(const std::vector<uint32_t>& keys, uint32_t k) override;
+  Results Unique(const std::vector<uint32_t>& keys, const std::vector<uint32_t>& values) override;
+  Results RunLengthEncode(const std::vector<uint32_t>& keys) override;
+  Results ReduceByKey(const std::vector<uint32_t>& keys,
+                      const std::vector<uint32_t>& values) override;
+  Results SortBoundaries(const std::vector<uint32_t>& keys, uint32_t prefix_bits) override;
+  Results Search(const std::vector<uint32_t>& keys, const std::vector<uint32_t>& queries) override;
+  Results Join(const std::vector<uint32_t>& left_keys,
+               const std::vector<uint32_t>& right_keys) override;
+  Results Histogram(const std::vector<uint32_t>& keys, uint32_t bit_offset, uint32_t bit_count,
+                    uint32_t bucket_count) override;
+  Results Multisplit(const std::vector<uint32_t>& keys, const std::vector<uint32_t>& values,
+                     uint32_t bit_offset, uint32_t bit_count) override;
 
  protected:
   void Reallocate(Buffer* buffer, VkDeviceSize size, VkBufferUsageFlags usage, bool mapped = false);
 
+  // Submits commands reading inputs from and writing outputs to host-visible primitives_, and
+  // waits. Host writes before and host reads after the call are made visible.
+  void Execute(const std::function<void(VkCommandBuffer)>& record);
+
+  static VkResult AllocateScratchBuffer(void* user_data, VkDeviceSize size,
+                                        VkBufferUsageFlags usage, VkBuffer* buffer);
+  static void FreeScratchBuffer(void* user_data, VkBuffer buffer);
+
  private:
   uint32_t min_buffer_alignment_ = 16;
   float timestamp_period_ = 1.f;
@@ -50,6 +107,11 @@ class VulkanBenchmark : public BenchmarkBase {
   Buffer keys_;
   Buffer storage_;
   Buffer staging_;
+  Buffer copy_;
+  Buffer primitives_;
+
+  // allocations of scratch pool buffers, used by sorted sets
+  std::unordered_map<VkBuffer, VmaAllocation> scratch_allocations_;
 };
 
 #endif  // VK_RADIX_SORT_VULKAN_BENCHMARK_H
@@ -76,6 +76,8 @@ function(build_shader)
     DEPENDS
       ${SHADER}
       ${CMAKE_CURRENT_SOURCE_DIR}/src/shader/constants.slang
+      ${CMAKE_CURRENT_SOURCE_DIR}/src/shader/local_sort.slang
+      ${CMAKE_CURRENT_SOURCE_DIR}/src/shader/workgroup_scan.slang
     COMMENT "Compiling ${CMAKE_CURRENT_SOURCE_DIR}/src/generated/${OUTPUT}.h"
     VERBATIM
   )